@@ -38,3 +38,50 @@ TEST_CASE ("Boot performance")
         });
     };
 }
+
+// Times processBlock on a freshly prepared plugin. Each run gets its own copy
+// of the random SH input, since processBlock renders in place and clears the
+// channels above the binaural output.
+static void benchmarkRender (const std::string& name,
+    double sampleRate,
+    int blockSize,
+    const std::function<void (PluginProcessor&)>& configure)
+{
+    PluginProcessor plugin;
+    configure (plugin);
+    plugin.prepareToPlay (sampleRate, blockSize);
+
+    juce::AudioBuffer<float> input (plugin.getTotalNumInputChannels(), blockSize);
+    juce::Random random;
+    for (int channel = 0; channel < input.getNumChannels(); ++channel)
+        for (int i = 0; i < blockSize; ++i)
+            input.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+    BENCHMARK_ADVANCED (name)
+    (Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<juce::AudioBuffer<float>> buffers (size_t (meter.runs()), input);
+        juce::MidiBuffer midi;
+        meter.measure ([&] (int i) { plugin.processBlock (buffers[(size_t) i], midi); });
+    };
+}
+
+TEST_CASE ("Render performance")
+{
+    auto gui = juce::ScopedJuceInitialiser_GUI {};
+
+    // Compare full-rate rendering against 44.1/48 kHz internal rendering
+    // at each host rate. Both variants process the same host block.
+    for (auto sampleRate : { 48000.0, 88200.0, 96000.0, 192000.0 })
+    {
+        for (auto internalRate : { false, true })
+        {
+            auto name = juce::String (sampleRate / 1000.0, 1) + " kHz host, "
+                        + (internalRate ? "internal rate" : "full rate");
+
+            benchmarkRender (name.toStdString(), sampleRate, 512, [&] (PluginProcessor& plugin) {
+                plugin.parameters.getParameter ("internal_rate_rendering")->setValueNotifyingHost (internalRate ? 1.0f : 0.0f);
+            });
+        }
+    }
+}
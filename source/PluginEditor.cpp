@@ -55,19 +55,25 @@ PluginEditor::PluginEditor(PluginProcessor& p)
   head_tracking_enabled_toggle_button.setButtonText("Enable Head Tracking");
   head_tracking_enabled_toggle_button.onClick = [this] {
     // Toggle head tracking.
-    processorRef.iamfbr_->EnableHeadTracking(
+    processorRef.setHeadTrackingEnabled(
         head_tracking_enabled_toggle_button.getToggleState());
-    if (head_tracking_enabled_toggle_button.getToggleState()) {
-      processorRef.connectOSC(true);
-    } else {
-      processorRef.connectOSC(false);
-    }
   };
+  head_tracking_enabled_toggle_button.setToggleState(
+      processorRef.getHeadTrackingEnabled(), juce::dontSendNotification);
 
   // Set up 'Head Orientation' label.
   addAndMakeVisible(head_orientation_label);
   head_orientation_label.setText("nothing set yet", juce::dontSendNotification);
 
+  // Set up 'Internal Rate Rendering' toggle button.
+  addAndMakeVisible(internal_rate_rendering_toggle_button);
+  internal_rate_rendering_toggle_button.setButtonText(
+      "Render at 44.1/48 kHz internally");
+  internal_rate_rendering_attachment = std::make_unique<
+      juce::AudioProcessorValueTreeState::ButtonAttachment>(
+      processorRef.parameters, "internal_rate_rendering",
+      internal_rate_rendering_toggle_button);
+
   // Add log window.
   logWindow.setMultiLine(true, false);
   logWindow.setReadOnly(true);
@@ -138,12 +144,14 @@ void PluginEditor::resized() {
       label_x, margin + label_height * 3, label_width, label_height);
   iamfbr_number_of_audio_elements_label.setBounds(
       label_x, margin + label_height * 4, label_width, label_height);
+  internal_rate_rendering_toggle_button.setBounds(
+      label_x, margin + label_height * 5, label_width, label_height);
   host_bus_width_too_small_label.setBounds(
-      margin, margin + label_height * 5, getWidth() - 2 * margin, label_height);
+      margin, margin + label_height * 6, getWidth() - 2 * margin, label_height);
 
-  logWindow.setBounds(margin, margin + label_height * 6,
+  logWindow.setBounds(margin, margin + label_height * 7,
                       getWidth() - 2 * margin,
-                      getHeight() - 3 * margin - label_height * 5);
+                      getHeight() - 3 * margin - label_height * 6);
 }
 
 void PluginEditor::timerCallback() {
@@ -168,7 +176,11 @@ void PluginEditor::timerCallback() {
       juce::dontSendNotification);
   iamfbr_sampling_rate_label.setText(
       "Sampling rate: " +
-          juce::String(processorRef.iamfbr_->GetSamplingRate()) + " Hz",
+          juce::String(processorRef.iamfbr_->GetSamplingRate()) + " Hz" +
+          (processorRef.isRenderingAtInternalRate()
+               ? " (" + juce::String(processorRef.getLatencySamples()) +
+                     " samples latency)"
+               : juce::String()),
       juce::dontSendNotification);
   iamfbr_number_of_input_channels_label.setText(
       "Number of input channels: " +
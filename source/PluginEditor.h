@@ -25,6 +25,10 @@ class PluginEditor : public juce::AudioProcessorEditor, public juce::Timer {
   juce::ToggleButton head_tracking_enabled_toggle_button;
   juce::Label head_orientation_label;
 
+  juce::ToggleButton internal_rate_rendering_toggle_button;
+  std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment>
+      internal_rate_rendering_attachment;
+
   juce::TextEditor logWindow;
 
   juce::Label iamfbr_number_of_audio_elements_label;
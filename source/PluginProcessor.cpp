@@ -2,6 +2,25 @@
 
 #include "PluginEditor.h"
 
+namespace {
+
+// Returns the power-of-two factor that brings |sample_rate| down to exactly
+// 44.1 or 48 kHz, or 1 if the host rate is not such a multiple of either or
+// |block_size| does not divide by the factor.
+int getInternalRateFactor(double sample_rate, int block_size) {
+  for (auto internal_rate : {44100.0, 48000.0}) {
+    for (int factor = 2; internal_rate * factor < sample_rate + 1.0;
+         factor *= 2) {
+      if (std::abs(sample_rate - internal_rate * factor) < 1.0)
+        return block_size % factor == 0 ? factor : 1;
+    }
+  }
+
+  return 1;
+}
+
+}  // namespace
+
 PluginProcessor::PluginProcessor()
     : AudioProcessor(
           BusesProperties()
@@ -11,6 +30,7 @@ PluginProcessor::PluginProcessor()
       parameters(*this, &undo_manager, "PARAMETERS", createParameterLayout()) {
   // Add parameters.
   parameters.addParameterListener("audio_element_type", this);
+  parameters.addParameterListener("internal_rate_rendering", this);
 }
 
 const juce::String PluginProcessor::getName() const { return JucePlugin_Name; }
@@ -65,14 +85,45 @@ void PluginProcessor::changeProgramName(int index,
 
 //==============================================================================
 void PluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
-  iamfbr_ = std::make_unique<obr::ObrImpl>(samplesPerBlock, sampleRate);
+  resampling_factor = 1;
+  if (parameters.getRawParameterValue("internal_rate_rendering")->load() >
+      0.5f) {
+    resampling_factor = getInternalRateFactor(sampleRate, samplesPerBlock);
+  }
+
+  sh_decimator.reset();
+  binaural_interpolator.reset();
+  if (resampling_factor > 1) {
+    sh_decimator = std::make_unique<PolyphaseResampler>(
+        PolyphaseResampler::Mode::kDecimate, sampleRate, resampling_factor,
+        juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels()),
+        samplesPerBlock);
+    binaural_interpolator = std::make_unique<PolyphaseResampler>(
+        PolyphaseResampler::Mode::kInterpolate, sampleRate, resampling_factor,
+        getTotalNumOutputChannels(), samplesPerBlock);
+    setLatencySamples(sh_decimator->getLatencySamples() +
+                      binaural_interpolator->getLatencySamples());
+  } else {
+    setLatencySamples(0);
+  }
+
+  iamfbr_ = std::make_unique<obr::ObrImpl>(samplesPerBlock / resampling_factor,
+                                           sampleRate / resampling_factor);
+
+  // Restore head tracking state on the new renderer.
+  iamfbr_->EnableHeadTracking(head_tracking_enabled);
+  if (head_tracking_enabled) iamfbr_->SetHeadRotation(qW, qX, qY, qZ);
 
   auto value =
       parameters.getParameter("audio_element_type")->getCurrentValueAsText();
   setAudioElementType(value.toStdString());
 }
 
-void PluginProcessor::releaseResources() { iamfbr_.reset(); }
+void PluginProcessor::releaseResources() {
+  iamfbr_.reset();
+  sh_decimator.reset();
+  binaural_interpolator.reset();
+}
 
 void PluginProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                    juce::MidiBuffer& midiMessages) {
@@ -117,7 +168,9 @@ void PluginProcessor::processBlock(juce::AudioBuffer<float>& buffer,
   }
 
   // Check if the number of samples is correct.
-  if (numSamples != iamfbr_->GetBufferSizePerChannel()) {
+  auto numInternalSamples = numSamples / static_cast<size_t>(resampling_factor);
+  if (numSamples % static_cast<size_t>(resampling_factor) != 0 ||
+      numInternalSamples != iamfbr_->GetBufferSizePerChannel()) {
     // Clear all channels.
     for (int channel = 0; channel < buffer.getNumChannels(); ++channel) {
       buffer.clear(channel, 0, buffer.getNumSamples());
@@ -126,23 +179,36 @@ void PluginProcessor::processBlock(juce::AudioBuffer<float>& buffer,
   }
 
   // Declare input and output buffers.
-  obr::AudioBuffer input_buffer(numInputChannels, numSamples);
-  obr::AudioBuffer output_buffer(numOutputChannels, numSamples);
+  obr::AudioBuffer input_buffer(numInputChannels, numInternalSamples);
+  obr::AudioBuffer output_buffer(numOutputChannels, numInternalSamples);
 
-  // Copy data from juce::AudioBuffer to iamfbr::AudioBuffer.
+  // Copy data from juce::AudioBuffer to iamfbr::AudioBuffer, decimating to
+  // the internal rate if enabled.
   for (size_t channel = 0; channel < numInputChannels; ++channel) {
     const float* source = buffer.getReadPointer(static_cast<int>(channel));
     auto& dest = input_buffer[channel];
-    std::copy(source, source + numSamples, dest.begin());
+    if (sh_decimator) {
+      sh_decimator->process(static_cast<int>(channel), source,
+                            static_cast<int>(numSamples), dest.begin());
+    } else {
+      std::copy(source, source + numSamples, dest.begin());
+    }
   }
 
   iamfbr_->Process(input_buffer, &output_buffer);
 
-  // Copy data from iamfbr::AudioBuffer to juce::AudioBuffer.
+  // Copy data from iamfbr::AudioBuffer to juce::AudioBuffer, interpolating
+  // back to the host rate if enabled.
   for (size_t channel = 0; channel < numOutputChannels; ++channel) {
     const auto& source = output_buffer[channel];
     float* dest = buffer.getWritePointer(static_cast<int>(channel));
-    std::copy(source.begin(), source.end(), dest);
+    if (binaural_interpolator) {
+      binaural_interpolator->process(static_cast<int>(channel), source.begin(),
+                                     static_cast<int>(numInternalSamples),
+                                     dest);
+    } else {
+      std::copy(source.begin(), source.end(), dest);
+    }
   }
 
   // Clear the remaining channels.
@@ -248,6 +314,14 @@ void PluginProcessor::parameterChanged(const juce::String& parameterID,
     auto value =
         parameters.getParameter("audio_element_type")->getCurrentValueAsText();
     setAudioElementType(value.toStdString());
+  } else if (parameterID == "internal_rate_rendering") {
+    // Changing the internal rate rebuilds the renderer and the latency, so
+    // re-prepare with the current host settings while processing is held.
+    if (iamfbr_) {
+      suspendProcessing(true);
+      prepareToPlay(getSampleRate(), getBlockSize());
+      suspendProcessing(false);
+    }
   }
 }
 
@@ -265,9 +339,20 @@ PluginProcessor::createParameterLayout() {
       juce::ParameterID{"audio_element_type", 1}, "Audio Element Type",
       stringArray, 0));
 
+  layout.add(std::make_unique<juce::AudioParameterBool>(
+      juce::ParameterID{"internal_rate_rendering", 1},
+      "Internal Rate Rendering", false,
+      juce::AudioParameterBoolAttributes().withAutomatable(false)));
+
   return layout;
 }
 
+void PluginProcessor::setHeadTrackingEnabled(bool enabled) {
+  head_tracking_enabled = enabled;
+  if (iamfbr_) iamfbr_->EnableHeadTracking(enabled);
+  connectOSC(enabled);
+}
+
 void PluginProcessor::connectOSC(bool toBeConnected) {
   if (toBeConnected) {
     if (juce::OSCReceiver::connect(12345)) {
@@ -3,6 +3,7 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_osc/juce_osc.h>
 
+#include "PolyphaseResampler.h"
 #include "obr/renderer/obr_impl.h"
 
 #if (MSVC)
@@ -48,7 +49,7 @@ class PluginProcessor
   std::unique_ptr<obr::ObrImpl> iamfbr_;
 
   // Head rotation.
-  float qX = 0.0f, qY = 0.0f, qZ = 0.0f, qW = 0.0f;
+  float qX = 0.0f, qY = 0.0f, qZ = 0.0f, qW = 1.0f;
 
   void setAudioElementType(std::string audio_element_type);
   void removeLastAudioElement();
@@ -60,11 +61,28 @@ class PluginProcessor
 
   bool getBusWidthTooSmall() const { return bus_width_too_small; }
 
+  // True when the renderer runs at a 44.1/48 kHz internal rate below the host
+  // rate (see the "internal_rate_rendering" parameter).
+  bool isRenderingAtInternalRate() const { return resampling_factor > 1; }
+
+  // Enables head tracking on the renderer and connects the OSC receiver. The
+  // state is kept here so it survives the renderer being rebuilt.
+  void setHeadTrackingEnabled(bool enabled);
+  bool getHeadTrackingEnabled() const { return head_tracking_enabled; }
+
   void connectOSC(bool toBeConnected);
 
  private:
   juce::UndoManager undo_manager;
   bool bus_width_too_small = false;
+  bool head_tracking_enabled = false;
+
+  // Internal fixed-rate rendering: the SH input is decimated before the
+  // renderer and only the binaural output is interpolated back up.
+  int resampling_factor = 1;
+  std::unique_ptr<PolyphaseResampler> sh_decimator;
+  std::unique_ptr<PolyphaseResampler> binaural_interpolator;
+
   static juce::AudioProcessorValueTreeState::ParameterLayout
   createParameterLayout();
 
@@ -0,0 +1,172 @@
+#include "PolyphaseResampler.h"
+
+namespace {
+
+// Fraction of the internal Nyquist frequency kept flat by the half-band
+// cascade. At 48 kHz this preserves content up to 20.4 kHz.
+constexpr double kPassbandFraction = 0.85;
+
+// Stopband attenuation of each half-band stage.
+constexpr float kStopbandAttenuationDb = -90.0f;
+
+std::vector<float> designHalfBandTaps(double stage_high_rate,
+                                      double passband_edge) {
+  auto transition_width =
+      static_cast<float>(2.0 * (0.25 - passband_edge / stage_high_rate));
+  transition_width = juce::jlimit(0.01f, 0.45f, transition_width);
+
+  auto coefficients = juce::dsp::FilterDesign<float>::
+      designFIRLowpassHalfBandEquirippleMethod(transition_width,
+                                               kStopbandAttenuationDb);
+  auto num_taps = static_cast<size_t>(coefficients->getFilterOrder() + 1);
+  const float* raw = coefficients->getRawCoefficients();
+  std::vector<float> taps(raw, raw + num_taps);
+
+  // Normalise to unity DC gain.
+  float sum = 0.0f;
+  for (auto tap : taps) sum += tap;
+  for (auto& tap : taps) tap /= sum;
+
+  return taps;
+}
+
+}  // namespace
+
+//==============================================================================
+PolyphaseFirStage::PolyphaseFirStage(Mode stage_mode,
+                                     const std::vector<float>& taps,
+                                     int stage_factor, int num_channels,
+                                     int max_input_samples)
+    : mode(stage_mode),
+      factor(stage_factor),
+      num_taps(static_cast<int>(taps.size())) {
+  jassert(factor > 1);
+  jassert(num_taps % 2 == 1);  // Linear phase with an integer group delay.
+
+  if (mode == Mode::kDecimate) {
+    // y[m] = sum_n h[n] x[factor * m - n]
+    branches.resize(1);
+    for (int n = 0; n < num_taps; ++n) {
+      auto gain = taps[static_cast<size_t>(n)];
+      if (gain != 0.0f) branches[0].push_back({n, gain});
+    }
+    history_length = num_taps - 1;
+  } else {
+    // z[factor * j + p] = factor * sum_q h[p + factor * q] x[j - q]
+    branches.resize(static_cast<size_t>(factor));
+    for (int n = 0; n < num_taps; ++n) {
+      auto gain = taps[static_cast<size_t>(n)] * static_cast<float>(factor);
+      if (gain != 0.0f)
+        branches[static_cast<size_t>(n % factor)].push_back({n / factor, gain});
+    }
+    history_length = (num_taps - 1) / factor;
+  }
+
+  history.resize(static_cast<size_t>(num_channels));
+  for (auto& channel_history : history)
+    channel_history.resize(
+        static_cast<size_t>(history_length + max_input_samples));
+}
+
+void PolyphaseFirStage::process(int channel, const float* input,
+                                int num_input_samples, float* output) {
+  auto& buffer = history[static_cast<size_t>(channel)];
+  jassert(history_length + num_input_samples <=
+          static_cast<int>(buffer.size()));
+
+  std::copy(input, input + num_input_samples,
+            buffer.begin() + history_length);
+  const float* samples = buffer.data() + history_length;
+
+  if (mode == Mode::kDecimate) {
+    jassert(num_input_samples % factor == 0);
+    const auto& taps = branches[0];
+    for (int m = 0; m < num_input_samples / factor; ++m) {
+      const float* current = samples + factor * m;
+      float sum = 0.0f;
+      for (const auto& tap : taps) sum += tap.gain * current[-tap.offset];
+      output[m] = sum;
+    }
+  } else {
+    for (int j = 0; j < num_input_samples; ++j) {
+      const float* current = samples + j;
+      for (int p = 0; p < factor; ++p) {
+        float sum = 0.0f;
+        for (const auto& tap : branches[static_cast<size_t>(p)])
+          sum += tap.gain * current[-tap.offset];
+        output[factor * j + p] = sum;
+      }
+    }
+  }
+
+  // Keep the most recent samples for the next block.
+  std::copy(buffer.begin() + num_input_samples,
+            buffer.begin() + num_input_samples + history_length,
+            buffer.begin());
+}
+
+void PolyphaseFirStage::reset() {
+  for (auto& channel_history : history)
+    std::fill(channel_history.begin(), channel_history.end(), 0.0f);
+}
+
+//==============================================================================
+PolyphaseResampler::PolyphaseResampler(Mode resampler_mode,
+                                       double high_sample_rate, int factor,
+                                       int num_channels,
+                                       int max_high_rate_block)
+    : mode(resampler_mode) {
+  jassert(juce::isPowerOfTwo(factor) && factor > 1);
+  jassert(max_high_rate_block % factor == 0);
+
+  auto num_stages = 0;
+  while ((1 << num_stages) < factor) ++num_stages;
+
+  auto passband_edge = kPassbandFraction * 0.5 * high_sample_rate / factor;
+
+  for (int i = 0; i < num_stages; ++i) {
+    // Ratio between the host rate and the high rate of this stage.
+    auto divisor = mode == Mode::kDecimate ? 1 << i : 1 << (num_stages - 1 - i);
+    auto taps = designHalfBandTaps(high_sample_rate / divisor, passband_edge);
+    auto max_input_samples = mode == Mode::kDecimate
+                                 ? max_high_rate_block / divisor
+                                 : max_high_rate_block / divisor / 2;
+
+    stages.push_back(std::make_unique<PolyphaseFirStage>(
+        mode, taps, 2, num_channels, max_input_samples));
+    stage_rate_divisors.push_back(divisor);
+
+    // Intermediate output between this stage and the next one.
+    if (i < num_stages - 1)
+      scratch.emplace_back(static_cast<size_t>(
+          mode == Mode::kDecimate ? max_input_samples / 2
+                                  : max_input_samples * 2));
+  }
+}
+
+void PolyphaseResampler::process(int channel, const float* input,
+                                 int num_input_samples, float* output) {
+  const float* stage_input = input;
+  auto stage_samples = num_input_samples;
+
+  for (size_t i = 0; i < stages.size(); ++i) {
+    float* stage_output =
+        i + 1 == stages.size() ? output : scratch[i].data();
+    stages[i]->process(channel, stage_input, stage_samples, stage_output);
+
+    stage_input = stage_output;
+    stage_samples =
+        mode == Mode::kDecimate ? stage_samples / 2 : stage_samples * 2;
+  }
+}
+
+void PolyphaseResampler::reset() {
+  for (auto& stage : stages) stage->reset();
+}
+
+int PolyphaseResampler::getLatencySamples() const {
+  int latency = 0;
+  for (size_t i = 0; i < stages.size(); ++i)
+    latency += stages[i]->getDelayAtHighRate() * stage_rate_divisors[i];
+  return latency;
+}
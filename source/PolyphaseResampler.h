@@ -0,0 +1,81 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+
+#include <vector>
+
+//==============================================================================
+// Integer-factor polyphase FIR stage. When decimating, the filter is only
+// evaluated at the retained output instants; when interpolating, each output
+// phase only sees the taps that line up with non-stuffed input samples. Zero
+// taps (every other tap of a half-band filter) are dropped at construction.
+class PolyphaseFirStage {
+ public:
+  enum class Mode { kDecimate, kInterpolate };
+
+  PolyphaseFirStage(Mode mode, const std::vector<float>& taps, int factor,
+                    int num_channels, int max_input_samples);
+
+  // Filters |num_input_samples| of |channel| into |output|, which receives
+  // num_input_samples / factor samples when decimating and
+  // num_input_samples * factor samples when interpolating.
+  void process(int channel, const float* input, int num_input_samples,
+               float* output);
+
+  void reset();
+
+  // Group delay of the linear-phase filter, in samples at the high rate.
+  int getDelayAtHighRate() const { return (num_taps - 1) / 2; }
+
+ private:
+  struct Tap {
+    int offset;
+    float gain;
+  };
+
+  Mode mode;
+  int factor;
+  int num_taps;
+  int history_length;
+
+  // A single branch when decimating, |factor| branches when interpolating.
+  std::vector<std::vector<Tap>> branches;
+  std::vector<std::vector<float>> history;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PolyphaseFirStage)
+};
+
+//==============================================================================
+// Power-of-two sample rate converter built from cascaded half-band stages.
+// Used to run the renderer at a fixed 44.1/48 kHz internal rate when the host
+// runs at 88.2 kHz and above.
+class PolyphaseResampler {
+ public:
+  using Mode = PolyphaseFirStage::Mode;
+
+  // |high_sample_rate| is the host rate, |factor| must be a power of two and
+  // |max_high_rate_block| a multiple of |factor|.
+  PolyphaseResampler(Mode mode, double high_sample_rate, int factor,
+                     int num_channels, int max_high_rate_block);
+
+  // Decimates |num_input_samples| host-rate samples to the internal rate, or
+  // interpolates |num_input_samples| internal-rate samples to the host rate.
+  void process(int channel, const float* input, int num_input_samples,
+               float* output);
+
+  void reset();
+
+  // Total group delay of the cascade, in samples at the host rate.
+  int getLatencySamples() const;
+
+ private:
+  Mode mode;
+
+  // Ordered in processing direction: highest rate first when decimating,
+  // lowest rate first when interpolating.
+  std::vector<std::unique_ptr<PolyphaseFirStage>> stages;
+  std::vector<int> stage_rate_divisors;
+  std::vector<std::vector<float>> scratch;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PolyphaseResampler)
+};
@@ -0,0 +1,129 @@
+#include <PluginProcessor.h>
+#include <PolyphaseResampler.h>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE ("Polyphase resampler round trip", "[resampler]")
+{
+    constexpr int blockSize = 512;
+    constexpr int numBlocks = 32;
+
+    for (auto factor : { 2, 4 })
+    {
+        auto sampleRate = 48000.0 * factor;
+        PolyphaseResampler decimator (PolyphaseResampler::Mode::kDecimate, sampleRate, factor, 1, blockSize);
+        PolyphaseResampler interpolator (PolyphaseResampler::Mode::kInterpolate, sampleRate, factor, 1, blockSize);
+        auto latency = decimator.getLatencySamples() + interpolator.getLatencySamples();
+
+        std::vector<float> input (blockSize * numBlocks), output (input.size()), internal (blockSize / factor);
+        for (size_t i = 0; i < input.size(); ++i)
+            input[i] = std::sin (juce::MathConstants<float>::twoPi * 1000.0f * static_cast<float> (i / sampleRate));
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            decimator.process (0, input.data() + block * blockSize, blockSize, internal.data());
+            interpolator.process (0, internal.data(), blockSize / factor, output.data() + block * blockSize);
+        }
+
+        // A passband tone comes back unchanged, delayed by the reported latency.
+        for (auto i = static_cast<size_t> (2 * latency); i < output.size(); ++i)
+            REQUIRE (std::abs (output[i] - input[i - static_cast<size_t> (latency)]) < 1.0e-3f);
+    }
+}
+
+TEST_CASE ("Internal rate rendering", "[resampler]")
+{
+    auto gui = juce::ScopedJuceInitialiser_GUI {};
+    PluginProcessor plugin;
+    plugin.parameters.getParameter ("internal_rate_rendering")->setValueNotifyingHost (1.0f);
+
+    SECTION ("renders at 48 kHz and reports latency at 96 kHz")
+    {
+        plugin.prepareToPlay (96000.0, 512);
+        CHECK (plugin.isRenderingAtInternalRate());
+        CHECK (plugin.iamfbr_->GetBufferSizePerChannel() == 256);
+        CHECK (plugin.getLatencySamples() > 0);
+    }
+
+    SECTION ("renders at 44.1 kHz at 176.4 kHz")
+    {
+        plugin.prepareToPlay (176400.0, 512);
+        CHECK (plugin.isRenderingAtInternalRate());
+        CHECK (plugin.iamfbr_->GetBufferSizePerChannel() == 128);
+    }
+
+    SECTION ("stays at the host rate at 48 kHz")
+    {
+        plugin.prepareToPlay (48000.0, 512);
+        CHECK_FALSE (plugin.isRenderingAtInternalRate());
+        CHECK (plugin.getLatencySamples() == 0);
+    }
+
+    SECTION ("stays at the host rate at 90 kHz")
+    {
+        plugin.prepareToPlay (90000.0, 512);
+        CHECK_FALSE (plugin.isRenderingAtInternalRate());
+        CHECK (plugin.iamfbr_->GetBufferSizePerChannel() == 512);
+    }
+
+    SECTION ("stays at the host rate when the block does not divide")
+    {
+        plugin.prepareToPlay (96000.0, 511);
+        CHECK_FALSE (plugin.isRenderingAtInternalRate());
+    }
+}
+
+TEST_CASE ("Internal rate rendering matches full rate rendering", "[resampler]")
+{
+    auto gui = juce::ScopedJuceInitialiser_GUI {};
+    constexpr double sampleRate = 96000.0;
+    constexpr int blockSize = 512;
+    constexpr int numBlocks = 32;
+
+    PluginProcessor fullRate, internalRate;
+    internalRate.parameters.getParameter ("internal_rate_rendering")->setValueNotifyingHost (1.0f);
+    fullRate.prepareToPlay (sampleRate, blockSize);
+    internalRate.prepareToPlay (sampleRate, blockSize);
+    REQUIRE (internalRate.isRenderingAtInternalRate());
+
+    auto latency = static_cast<size_t> (internalRate.getLatencySamples());
+    auto numChannels = internalRate.getTotalNumInputChannels();
+    std::vector<std::vector<float>> fullRateOutput (2), internalRateOutput (2);
+    juce::MidiBuffer midi;
+
+    // An in-band tone on the first input channel, rendered by both processors.
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        juce::AudioBuffer<float> fullRateBuffer (numChannels, blockSize);
+        fullRateBuffer.clear();
+        for (int i = 0; i < blockSize; ++i)
+        {
+            auto time = static_cast<float> ((block * blockSize + i) / sampleRate);
+            fullRateBuffer.setSample (0, i, 0.5f * std::sin (juce::MathConstants<float>::twoPi * 1000.0f * time));
+        }
+        juce::AudioBuffer<float> internalRateBuffer (fullRateBuffer);
+
+        fullRate.processBlock (fullRateBuffer, midi);
+        internalRate.processBlock (internalRateBuffer, midi);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            auto* full = fullRateBuffer.getReadPointer (channel);
+            auto* internal = internalRateBuffer.getReadPointer (channel);
+            fullRateOutput[(size_t) channel].insert (fullRateOutput[(size_t) channel].end(), full, full + blockSize);
+            internalRateOutput[(size_t) channel].insert (internalRateOutput[(size_t) channel].end(), internal, internal + blockSize);
+        }
+    }
+
+    // Compare once the renderer and resampler tails have settled.
+    for (size_t channel = 0; channel < 2; ++channel)
+    {
+        const auto& reference = fullRateOutput[channel];
+        float peak = 0.0f;
+        for (auto sample : reference)
+            peak = std::max (peak, std::abs (sample));
+        REQUIRE (peak > 0.0f);
+
+        for (auto i = reference.size() / 2; i < reference.size(); ++i)
+            REQUIRE (std::abs (internalRateOutput[channel][i] - reference[i - latency]) < 0.05f * peak);
+    }
+}